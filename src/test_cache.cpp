@@ -55,6 +55,44 @@ struct Point : WithIntKey
     { return strm << p.key << "[" << std::hex << std::setw(16) << p.data << "]" << (p.marked ? "{*}" : ""); }
 };
 
+struct Counted : WithIntKey
+{
+    static inline std::size_t alive = 0;
+
+    Counted(const int key_)
+        : WithIntKey(key_)
+    { ++alive; }
+
+    ~Counted() override
+    { --alive; }
+};
+
+struct WithStringKey
+{
+    const std::string key;
+
+    WithStringKey(const std::string & key_)
+        : key(key_)
+    { }
+
+    virtual ~WithStringKey() = default;
+
+    bool operator == (const std::string & other_key) const
+    { return key == other_key; }
+};
+
+struct Symbol : WithStringKey
+{
+    unsigned long long volume = 0;
+
+    Symbol(const std::string & key_)
+        : WithStringKey(key_)
+    {}
+
+    friend std::ostream & operator << (std::ostream & strm, const Symbol & s)
+    { return strm << s.key << "[" << s.volume << "]"; }
+};
+
 template <std::size_t size>
 using Size = std::integral_constant<std::size_t, size>;
 
@@ -321,3 +359,139 @@ TYPED_TEST(SecondChanceTest, add_full__then_revisit_half__then_add_half)
     }
     EXPECT_EQ(this->cache_size, this->cache.size());
 }
+
+TYPED_TEST(SecondChanceTest, evicted_items_destroyed)
+{
+    using String = typename TestFixture::String;
+    const std::size_t total = 3 * this->cache_size;
+    {
+        Cache<int, WithIntKey, AllocatorWithPool> cache(this->cache_size, (this->cache_size + 1) * std::max(sizeof(Counted), sizeof(String)));
+        for (std::size_t i = 0; i < total; ++i) {
+            const int n = static_cast<int>(i);
+            if (i % 2) {
+                EXPECT_EQ(std::to_string(n), cache.get<String>(n).data);
+            }
+            else {
+                EXPECT_EQ(n, cache.get<Counted>(n).key);
+            }
+            EXPECT_LE(Counted::alive, this->cache_size);
+        }
+        std::size_t expected = 0;
+        for (std::size_t i = total - this->cache_size; i < total; ++i) {
+            if (i % 2 == 0) {
+                ++expected;
+            }
+        }
+        EXPECT_EQ(expected, Counted::alive);
+        EXPECT_EQ(this->cache_size, cache.size());
+    }
+    EXPECT_EQ(0, Counted::alive);
+}
+
+TYPED_TEST(SecondChanceTest, add_full__colliding_keys)
+{
+    const int step = 1 << 16;
+    int n = -static_cast<int>(this->cache_size / 2);
+    for (std::size_t i = 0; i < this->cache_size; ++i, ++n) {
+        if (i % 2) {
+            this->get_point(n * step).marked = true;
+        }
+        else {
+            this->get_string(n * step).data += '%';
+        }
+    }
+    EXPECT_EQ(this->cache_size, this->cache.size());
+
+    n = -static_cast<int>(this->cache_size / 2);
+    for (std::size_t i = 0; i < this->cache_size; ++i, ++n) {
+        if (i % 2) {
+            const auto & p = this->get_point(n * step);
+            EXPECT_EQ(Point::convert_data(n * step), p.data) << "Wrong item " << n * step << ": " << p;
+            EXPECT_TRUE(p.marked) << "Wrong item " << n * step << ": " << p;
+        }
+        else {
+            const auto & s = this->get_string(n * step);
+            const auto expected = std::to_string(n * step) + '%';
+            EXPECT_EQ(expected, s.data) << "Wrong item " << n * step << ": " << s;
+        }
+    }
+    EXPECT_EQ(this->cache_size, this->cache.size());
+}
+
+TEST(StringKeyTest, short_and_long_keys)
+{
+    const std::string long_key(100, 'L');
+    Cache<std::string, WithStringKey, AllocatorWithPool> cache(3, 4 * sizeof(Symbol));
+
+    cache.get<Symbol>("AAPL").volume = 1;
+    cache.get<Symbol>(std::string("MSFT")).volume = 2;
+    cache.get<Symbol>(long_key).volume = 3;
+    EXPECT_EQ(3, cache.size());
+
+    EXPECT_EQ(1, cache.get<Symbol>(std::string("AAPL")).volume);
+    EXPECT_EQ(2, cache.get<Symbol>("MSFT").volume);
+    EXPECT_EQ(3, cache.get<Symbol>(std::string(100, 'L')).volume);
+
+    {
+        const auto & s = cache.get<Symbol>(long_key + 'L');
+        EXPECT_EQ(long_key + 'L', s.key);
+        EXPECT_EQ(0, s.volume) << "Wrong item: " << s;
+    }
+    EXPECT_EQ(3, cache.size());
+    EXPECT_EQ(0, cache.get<Symbol>("").volume);
+    EXPECT_EQ(3, cache.size());
+}
+
+TYPED_TEST(SecondChanceTest, single_slot)
+{
+    using String = typename TestFixture::String;
+    Cache<int, WithIntKey, AllocatorWithPool> cache(1, 2 * std::max(sizeof(Point), sizeof(String)));
+    EXPECT_TRUE(cache.empty());
+
+    cache.get<String>(1).data += '@';
+    EXPECT_EQ("1@", cache.get<String>(1).data);
+    EXPECT_EQ(1, cache.size());
+
+    {
+        auto & p = cache.get<Point>(2);
+        EXPECT_FALSE(p.marked) << "Wrong item 2: " << p;
+        p.marked = true;
+    }
+    EXPECT_EQ(1, cache.size());
+    EXPECT_TRUE(cache.get<Point>(2).marked);
+
+    EXPECT_EQ("1", cache.get<String>(1).data);
+    EXPECT_EQ(1, cache.size());
+    EXPECT_FALSE(cache.get<Point>(2).marked);
+}
+
+TYPED_TEST(SecondChanceTest, add_full__revisit_first_many_times__add_full)
+{
+    int n = 200;
+    for (std::size_t i = 0; i < this->cache_size; ++i, ++n) {
+        this->get_string(n).data += '@';
+    }
+    for (int k = 0; k < 10; ++k) {
+        EXPECT_EQ("200@", this->get_string(200).data) << "Wrong item 200";
+    }
+
+    n = 300;
+    for (std::size_t i = 0; i < this->cache_size; ++i, ++n) {
+        auto & p = this->get_point(n);
+        EXPECT_FALSE(p.marked) << "Wrong item " << n << ": " << p;
+        p.marked = true;
+    }
+    EXPECT_EQ(this->cache_size, this->cache.size());
+
+    {
+        const auto & s = this->get_string(200);
+        const auto expected = std::to_string(200);
+        EXPECT_EQ(expected, s.data) << "Wrong item 200: " << s;
+    }
+    n = 301;
+    for (std::size_t i = 1; i < this->cache_size; ++i, ++n) {
+        const auto & p = this->get_point(n);
+        EXPECT_TRUE(p.marked) << "Wrong item " << n << ": " << p;
+    }
+    EXPECT_EQ(this->cache_size, this->cache.size());
+}